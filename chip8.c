@@ -1,10 +1,19 @@
 #include <stdio.h>
+#include <ctype.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "SDL.h"
 
+#include "chip8_core.h"
+
+#define WALL_GAP 1              // pixels between machines in wall view
+#define WALL_MAX_WIDTH 1280     // wall view window is scaled up or down to fit this width
+#define WALL_MAX_INSTANCES 4096 // largest wall, a 64x64 grid
+#define WALL_GAP_COLOUR 0x303030FF
+
 // SDL container struct.
 typedef struct
 {
@@ -21,44 +30,15 @@ typedef struct
     uint32_t background_colour; // RGNA8888.
     uint32_t scale_factor;      // Amount to scale each CHIP-8 pixel by. E.g. 20x will be 20x larger.
     bool pixel_outlines;        // Draw pixel "outlines" yes/no.
+    char **rom_names;           // ROM file(s) to run.
+    uint32_t n_roms;            // Number of ROM files.
+    uint32_t wall_instances;    // Machines in wall view, 0 for single machine.
+    uint32_t wall_columns;      // Wall view grid size.
+    uint32_t wall_rows;
+    uint32_t wall_window_width;  // Wall view SDL window size, the atlas is scaled to fit.
+    uint32_t wall_window_height;
 } config_t;
 
-// Emulator states.
-typedef enum
-{
-    QUIT,
-    RUNNING,
-    PAUSED,
-} emulator_state_t;
-
-typedef struct
-{
-    uint16_t opcode;
-    uint16_t NNN; // 12 bit address
-    uint8_t NN;   // 8 bit address
-    uint8_t N;    // 4 bit address
-    uint8_t X;    // 4 bit register identifier
-    uint8_t Y;    // 4 bit register identifier
-} instruction_t;
-
-// CHIP-8 machine struct.
-typedef struct
-{
-    emulator_state_t state;
-    uint8_t ram[4096];
-    bool display[64 * 32]; // original chip8 resolution
-    uint16_t stack[12];    // subroutine stack
-    uint16_t *stack_ptr;
-    uint8_t V[16];        // data registers V0-VF
-    uint16_t I;           // index registers
-    uint16_t PC;          // program counter
-    uint8_t delay_timer;  // decrements at 60hz when > 0
-    uint8_t sound_timer;  // decrements at 60hz and plays tone when > 0
-    bool keypad[16];      // hexadecimal keypad 0x0 - 0xF
-    const char *rom_name; // currently running ROM
-    instruction_t inst;   // currently executing instruction
-} chip8_t;
-
 // Initialise SDL function.
 bool initSDL(sdl_t *sdl, const config_t config)
 {
@@ -72,8 +52,8 @@ bool initSDL(sdl_t *sdl, const config_t config)
         "CHIP-8 Emulator",
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
-        config.window_width * config.scale_factor,
-        config.window_height * config.scale_factor,
+        config.wall_instances ? config.wall_window_width : config.window_width * config.scale_factor,
+        config.wall_instances ? config.wall_window_height : config.window_height * config.scale_factor,
         0);
 
     if (!sdl->window)
@@ -106,11 +86,44 @@ bool setConfig_Args(config_t *config, const int argc, char **argv)
     };
 
     // Override defaults.
-    for (int i = 0; i < argc; i++)
+    config->rom_names = &argv[1];
+    config->n_roms = 1;
+
+    if (argc > 1 && strcmp(argv[1], "--wall") == 0)
     {
-        (void)argv[i]; // Prevent compiler error due to unused argc/argv.
-        //...
-    };
+        // --wall <instances> <rom>...: grid of machines cycling through the ROMs.
+        if (argc < 4)
+            return false;
+        char *end;
+        const unsigned long instances = strtoul(argv[2], &end, 10);
+        if (!isdigit((unsigned char)argv[2][0]) || *end != '\0' || instances == 0 || instances > WALL_MAX_INSTANCES)
+            return false;
+        config->wall_instances = instances;
+        config->rom_names = &argv[3];
+        config->n_roms = argc - 3;
+
+        // near square grid, so the window keeps CHIP-8's 2:1 aspect
+        while (config->wall_columns * config->wall_columns < config->wall_instances)
+            config->wall_columns++;
+        config->wall_rows = (config->wall_instances + config->wall_columns - 1) / config->wall_columns;
+
+        config->window_width = config->wall_columns * (CHIP8_DISPLAY_WIDTH + WALL_GAP) - WALL_GAP;
+        config->window_height = config->wall_rows * (CHIP8_DISPLAY_HEIGHT + WALL_GAP) - WALL_GAP;
+
+        // whole multiple when scaling up, otherwise shrink to fit and let SDL_RenderCopy downscale
+        if (config->window_width < WALL_MAX_WIDTH)
+        {
+            const uint32_t scale = WALL_MAX_WIDTH / config->window_width;
+            config->wall_window_width = config->window_width * scale;
+            config->wall_window_height = config->window_height * scale;
+        }
+        else
+        {
+            config->wall_window_width = WALL_MAX_WIDTH;
+            config->wall_window_height = config->window_height * WALL_MAX_WIDTH / config->window_width;
+        }
+        config->pixel_outlines = false;
+    }
 
     return true;
 }
@@ -118,28 +131,7 @@ bool setConfig_Args(config_t *config, const int argc, char **argv)
 // Initialise CHIP-8 machine.
 bool initCHIP(chip8_t *chip8, const char rom_name[])
 {
-    const uint32_t entry_point = 0x200; // roms loaded to 0x200
-    const uint8_t font[] = {
-        0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
-        0x20, 0x60, 0x20, 0x20, 0x70, // 1
-        0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
-        0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
-        0x90, 0x90, 0xF0, 0x10, 0x10, // 4
-        0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
-        0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
-        0xF0, 0x10, 0x20, 0x40, 0x40, // 7
-        0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
-        0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
-        0xF0, 0x90, 0xF0, 0x90, 0x90, // A
-        0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
-        0xF0, 0x80, 0x80, 0x80, 0xF0, // C
-        0xE0, 0x90, 0x90, 0x90, 0xE0, // D
-        0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
-        0xF0, 0x80, 0xF0, 0x80, 0x80  // F
-    };
-
-    // load font
-    memcpy(&chip8->ram[0], font, sizeof(font));
+    uint8_t rom_data[sizeof chip8->ram - CHIP8_ENTRY_POINT];
 
     // open rom file
     FILE *rom = fopen(rom_name, "rb");
@@ -151,30 +143,31 @@ bool initCHIP(chip8_t *chip8, const char rom_name[])
     // check rom size
     fseek(rom, 0, SEEK_END);
     const size_t rom_size = ftell(rom);
-    const size_t max_size = sizeof chip8->ram - entry_point;
+    const size_t max_size = sizeof rom_data;
     rewind(rom);
 
     if (rom_size > max_size)
     {
         SDL_Log("ROM file %s is too big.\n Rom size: %zu.\nMax size allowed: %zu\n",
                 rom_name, rom_size, max_size);
+        fclose(rom);
         return false;
     }
 
-    // load rom
-    if (fread(&chip8->ram[entry_point], rom_size, 1, rom) != 1)
+    // read rom
+    if (fread(rom_data, rom_size, 1, rom) != 1)
     {
         SDL_Log("Could not read ROM file %s into CHIP-8 memory.\n",
                 rom_name);
+        fclose(rom);
         return false;
     };
     fclose(rom);
 
-    // set machine defaults
-    chip8->state = RUNNING;
-    chip8->PC = entry_point;
+    // load font + rom and set machine defaults
+    if (!chip8_load_rom_from_memory(chip8, rom_data, rom_size))
+        return false;
     chip8->rom_name = rom_name;
-    chip8->stack_ptr = &chip8->stack[0];
 
     return true; // Success.
 }
@@ -250,7 +243,7 @@ void updateScreen(const sdl_t sdl, const config_t config, const chip8_t chip8)
 }
 
 // Handle user input.
-void handleInput(chip8_t *chip8)
+void handleInput(chip8_state_t *state)
 {
     SDL_Event event;
 
@@ -260,7 +253,7 @@ void handleInput(chip8_t *chip8)
         {
         case SDL_QUIT:
             // Exit window or end program.
-            chip8->state = QUIT; // Will break the main emulator loop.
+            *state = CHIP8_QUIT; // Will break the main emulator loop.
             return;
 
         case SDL_KEYDOWN:
@@ -268,15 +261,15 @@ void handleInput(chip8_t *chip8)
             {
             case SDLK_ESCAPE:
                 // Escape key: exit window, and end program.
-                chip8->state = QUIT;
+                *state = CHIP8_QUIT;
                 return;
             case SDLK_SPACE:
                 // Space bar
-                if (chip8->state == RUNNING)
-                    chip8->state = PAUSED; // pause
+                if (*state == CHIP8_RUNNING)
+                    *state = CHIP8_PAUSED; // pause
                 else
                 {
-                    chip8->state = RUNNING;
+                    *state = CHIP8_RUNNING;
                     puts("==== PAUSED ====");
                 }
                 return;
@@ -294,394 +287,119 @@ void handleInput(chip8_t *chip8)
     }
 }
 
-#ifdef DEBUG
-void print_debug_info(chip8_t *chip8)
-{
-    printf("Address: 0x%04X | OpCode:0x%04X\nDesc: ",
-           chip8->PC - 2, chip8->inst.opcode);
-    switch ((chip8->inst.opcode >> 12) & 0x0F)
-    {
-    case 0x00:
-        // subroutine at NN
-        if (chip8->inst.NN == 0xE0)
-        {
-            // 0x00E0: clear screen
-            printf("Clear screen\n\n");
-        }
-        else if (chip8->inst.NN == 0xEE)
-        {
-            // 0x00EE: return from subroutine
-            // set program counter to last address on stack ("pop from stack")
-            //  so next opcode will be pulled from that address
-            printf("Return from subroutine to a new address 0x%04X\n\n",
-                   *(chip8->stack_ptr - 1));
-        }
-        else
-        {
-            printf("Unimplemented OpCode.\n\n");
-        }
-        break;
-    case 0x01:
-        // 0x1NNN: jumps to address NNN
-        printf("Jump to address NNN (0x%04X)\n\n", chip8->inst.NNN);
-        break;
-    case 0x02:
-        // 0x2NNN: call subroutine at NNN
-        *chip8->stack_ptr++ = chip8->PC; // store current address to return to on subroutine stack ("push on stack")
-        chip8->PC = chip8->inst.NNN;     // set program counter to subroutine address to pull next opcode.
-        break;
-    case 0x03:
-        // 0x3XNN: skip next instruction if VX == NN
-        printf("Check if V%X (0x%02X) == NN (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN);
-        break;
-    case 0x04:
-        // 0x4XNN: skip next instruction if VX != NN
-        printf("Check if V%X (0x%02X) != NN (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN);
-        break;
-    case 0x05:
-        // 0x5XY0: skip next instruction if VX == NN
-        printf("Check if V%X (0x%02X) == V%X (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y]);
-        break;
-    case 0x06:
-        // 0x6XNN: sets VX to NN
-        printf("Set register V%X to NN (0x%02X)\n\n", chip8->inst.X, chip8->inst.NN);
-        break;
-    case 0x07:
-        // 0x7XNN: sets VX += NN
-        printf("Set register V%X (0x%02X) to += NN (0x%02X). Result: %02X\n\n",
-               chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN, chip8->V[chip8->inst.X] + chip8->inst.NN);
-        break;
-    case 0x08:
-        switch (chip8->inst.N)
-        {
-        case 0:
-            // 0x8XY0: sets VX = VY
-            printf("Set register V%X = V%X (0x%02X)\n\n",
-                   chip8->inst.X, chip8->inst.Y, chip8->V[chip8->inst.Y]);
-            break;
-        case 1:
-            // 0x8XY1: sets VX |= VY
-            printf("Set register V%X (0x%02X) |= V%X (0x%02X). Result: 0x%02X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] | chip8->V[chip8->inst.Y]);
-            break;
-        case 2:
-            // 0x8XY2: sets VX &= VY
-            printf("Set register V%X (0x%02X) &= V%X (0x%02X). Result: 0x%02X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] & chip8->V[chip8->inst.Y]);
-            break;
-        case 3:
-            // 0x8XY3: sets VX ^= VY
-            printf("Set register V%X (0x%02X) ^= V%X (0x%02X). Result: 0x%02X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] ^ chip8->V[chip8->inst.Y]);
-            break;
-        case 4:
-            // 0x8XY4: sets VX += VY, set VF to 1 if carry, and 0 when not
-            printf("Set register V%X (0x%02X) += V%X (0x%02X), VF = 1 if carry. Result: 0x%02X, VF = %X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y],
-                   ((uint16_t)(chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y]) > 255));
-            break;
-        case 5:
-            // 0x8XY5: sets VX -= VY, set VF to 0 if borrow, and 1 when not
-            printf("Set register V%X (0x%02X) -= V%X (0x%02X), VF = 0 if borrow. Result: 0x%02X, VF = %X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] - chip8->V[chip8->inst.Y],
-                   (chip8->V[chip8->inst.X] <= chip8->V[chip8->inst.Y]));
-            break;
-        case 6:
-            // 0x8XY6: sets VX >>= 1, stores shifted bit into VF.
-            printf("Set register V%X (0x%02X) >>= 1, VF = shifted bit. Result: 0x%02X, VF = %X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->V[chip8->inst.X] >> 1,
-                   chip8->V[chip8->inst.X] & 1);
-            break;
-        case 7:
-            // 0x8XY7: sets VX = VY - VX, set VF to 0 if borrow, and 1 when not
-            printf("Set register V%X = V%X (0x%02X) - V%X (0x%02X), VF = 0 if borrow. Result: 0x%02X, VF = %X\n\n",
-                   chip8->inst.X,
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->inst.Y, chip8->V[chip8->inst.Y],
-                   chip8->V[chip8->inst.X] - chip8->V[chip8->inst.Y],
-                   (chip8->V[chip8->inst.Y] <= chip8->V[chip8->inst.X]));
-            break;
-        case 0xE:
-            // 0x8XYE: sets VX <<= 1, stores shifted bit into VF.
-            printf("Set register V%X (0x%02X) <<= 1, VF = shifted bit. Result: 0x%02X, VF = %X\n\n",
-                   chip8->inst.X, chip8->V[chip8->inst.X],
-                   chip8->V[chip8->inst.X] << 1,
-                   (chip8->V[chip8->inst.X] & 0x80) >> 7);
-            break;
-        }
-        break;
-    case 0x09:
-        // 0x9XY0: skip next instruction if VX != NN
-        printf("Check if V%X (0x%02X) != V%X (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y]);
-        break;
-    case 0x0A:
-        // 0xANNN: set index register I to NNN
-        printf("Set index register I to NNN (0x%04X)\n\n", chip8->inst.NNN);
-        break;
-    case 0x0D:
-        // 0xDXYN: Draw sprite at coordinate (VX, VY), read from memory location I
-        // sprite width 8, height N
-        // screen pixels are XOR'd with sprite bits
-        // VF (carry flag) set if any screen pixels are set off. Important for collision detection etc.
-        printf("Drawing N (%u) height sprite at coords V%X (0x%02X), V%X (0x%02X) "
-               "from memory location I (0x%04X).\nSet VF = 1 if any pixels are off.\n\n",
-               chip8->inst.N, chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y], chip8->I);
-        break;
-    default:
-        printf("Unimplemented OpCode.\n\n");
-        break; // invalid opcode
-    }
-};
-#endif
-
-// Emulate chip8 instructions:
-void emulateInstructions(chip8_t *chip8, const config_t config)
+// Copy a machine's dirty display rows into its cell of the wall atlas, and upload just those
+// rows of the cell to the texture. Returns false if the display did not change.
+bool updateWallCell(SDL_Texture *texture, uint32_t *atlas, const config_t config, chip8_t *chip8, uint32_t index)
 {
-    // get next opcode from ram
-    chip8->inst.opcode = chip8->ram[chip8->PC] << 8 | chip8->ram[chip8->PC + 1];
-    chip8->PC += 2; // pre-increment pc to get next op code
-
-    // fill out current instruction format
-    //  DXYN
-    chip8->inst.NNN = chip8->inst.opcode & 0x0FFF;
-    chip8->inst.NN = chip8->inst.opcode & 0x0FF;
-    chip8->inst.N = chip8->inst.opcode & 0x0F;
-    chip8->inst.X = (chip8->inst.opcode >> 8) & 0x0F;
-    chip8->inst.Y = (chip8->inst.opcode >> 4) & 0x0F;
-
-#ifdef DEBUG
-    print_debug_info(chip8);
-#endif
-
-    // emulate opcode
-    switch ((chip8->inst.opcode >> 12) & 0x0F)
-    {
-    case 0x00:
-        // subroutine at NN
-        if (chip8->inst.NN == 0xE0)
-        {
-            // 0x00E0: clear screen
-            memset(chip8->display, false, sizeof chip8->display);
-        }
-        else if (chip8->inst.NN == 0xEE)
-        {
-            // 0x00EE: return from subroutine
-            // set program counter to last address on stack ("pop from stack")
-            //  so next opcode will be pulled from that address
-            chip8->PC = *--chip8->stack_ptr;
-        }
-        else
-        {
-            // Unimplemented/invalid opcode, may be 0xNNN for calling machine code routine for RCA1802
-        }
-        break;
-
-    case 0x01:
-        // 0x1NNN: jumps to address NNN
-        chip8->PC = chip8->inst.NNN; // set program counter so next opcode is from NNN.
-        break;
-
-    case 0x02:
-        // 0x2NNN: call subroutine at NNN
-        *chip8->stack_ptr++ = chip8->PC; // store current address to return to on subroutine stack ("push on stack")
-        chip8->PC = chip8->inst.NNN;     // set program counter to subroutine address to pull next opcode.
-        break;
-
-    case 0x03:
-        // 0x3XNN: skip next instruction if VX == NN
-        if (chip8->V[chip8->inst.X] == chip8->inst.NN)
-        {
-            chip8->PC += 2; // skip next op code.
-        }
-        break;
-
-    case 0x04:
-        // 0x4XNN: skip next instruction if VX != NN
-        if (chip8->V[chip8->inst.X] != chip8->inst.NN)
-        {
-            chip8->PC += 2; // skip next op code.
-        }
-        break;
-
-    case 0x05:
-        // 0x5XY0: skip next instruction if VX == VY
-        if (chip8->inst.N != 0)
-        {
-            break; // wrong opcode
-        }
-        if (chip8->V[chip8->inst.X] == chip8->V[chip8->inst.Y])
-        {
-            chip8->PC += 2; // skip next op code.
-        }
-        break;
-
-    case 0x06:
-        // 0x6XNN: sets VX to NN
-        chip8->V[chip8->inst.X] = chip8->inst.NN;
-        break;
+    const uint32_t dirty_rows = chip8_take_dirty_rows(chip8);
+    if (!dirty_rows)
+        return false;
 
-    case 0x07:
-        // 0x7XNN: sets register VX += NN
-        chip8->V[chip8->inst.X] += chip8->inst.NN;
-        break;
+    const uint32_t cell_x = (index % config.wall_columns) * (CHIP8_DISPLAY_WIDTH + WALL_GAP);
+    const uint32_t cell_y = (index / config.wall_columns) * (CHIP8_DISPLAY_HEIGHT + WALL_GAP);
+    uint32_t first_row = CHIP8_DISPLAY_HEIGHT, last_row = 0;
 
-    case 0x08:
+    for (uint32_t y = 0; y < CHIP8_DISPLAY_HEIGHT; y++)
+    {
+        if (!(dirty_rows & (1u << y)))
+            continue;
 
-        switch (chip8->inst.N)
-        {
-        case 0:
-            // 0x8XY0: sets VX = VY
-            chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y];
-            break;
+        const bool *row = &chip8->display[y * CHIP8_DISPLAY_WIDTH];
+        uint32_t *pixels = &atlas[(cell_y + y) * config.window_width + cell_x];
+        for (uint32_t x = 0; x < CHIP8_DISPLAY_WIDTH; x++)
+            pixels[x] = row[x] ? config.foreground_colour : config.background_colour;
 
-        case 1:
-            // 0x8XY1: sets VX |= VY
-            chip8->V[chip8->inst.X] |= chip8->V[chip8->inst.Y];
-            break;
+        if (y < first_row)
+            first_row = y;
+        last_row = y;
+    }
 
-        case 2:
-            // 0x8XY2: sets VX &= VY
-            chip8->V[chip8->inst.X] &= chip8->V[chip8->inst.Y];
-            break;
+    const SDL_Rect rect = {.x = cell_x, .y = cell_y + first_row, .w = CHIP8_DISPLAY_WIDTH, .h = last_row - first_row + 1};
+    SDL_UpdateTexture(texture, &rect, &atlas[rect.y * config.window_width + rect.x],
+                      config.window_width * sizeof(uint32_t));
 
-        case 3:
-            // 0x8XY3: sets VX ^= VY
-            chip8->V[chip8->inst.X] ^= chip8->V[chip8->inst.Y];
-            break;
+    return true;
+}
 
-        case 4:
-            // 0x8XY4: sets VX += VY, set VF to 1 if carry, and 0 when not
-            if ((uint16_t)(chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y]) > 255)
-            {
-                chip8->V[0xF] = 1;
-                chip8->V[chip8->inst.X] += chip8->V[chip8->inst.Y];
-            }
-            else
-            {
-                chip8->V[0xF] = 0;
-                chip8->V[chip8->inst.X] += chip8->V[chip8->inst.Y];
-            };
-            break;
+// Run a grid of independent machines, presented as one streaming texture atlas.
+bool runWall(const sdl_t sdl, const config_t config)
+{
+    const uint32_t pitch = config.window_width * sizeof(uint32_t);
+    chip8_t *machines = calloc(config.wall_instances, sizeof *machines);
+    uint32_t *atlas = malloc(pitch * config.window_height);
+    if (config.window_width > config.wall_window_width)
+        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear"); // blend pixels when shrinking the atlas
+    SDL_Texture *texture = SDL_CreateTexture(sdl.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING,
+                                             config.window_width, config.window_height);
+    bool success = machines && atlas && texture;
+    if (!texture)
+        SDL_Log("Unable to create wall texture. %s", SDL_GetError());
+
+    // load ROMs round robin
+    for (uint32_t i = 0; success && i < config.wall_instances; i++)
+        success = initCHIP(&machines[i], config.rom_names[i % config.n_roms]);
+
+    if (success)
+    {
+        // colours are opaque on screen, don't blend with alpha channel
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
 
-        case 5:
-            // 0x8XY5: sets VX -= VY, set VF to 0 if borrow, and 1 when not
-            if (chip8->V[chip8->inst.Y] > chip8->V[chip8->inst.X])
-            {
-                chip8->V[0xF] = 0;
-                chip8->V[chip8->inst.X] -= chip8->V[chip8->inst.Y];
-            }
-            else
-            {
-                chip8->V[0xF] = 1;
-                chip8->V[chip8->inst.X] -= chip8->V[chip8->inst.Y];
-            }
-            break;
+        // gaps between cells; cells themselves are filled on first frame (all rows start dirty)
+        for (uint32_t i = 0; i < config.window_width * config.window_height; i++)
+            atlas[i] = WALL_GAP_COLOUR;
+    }
 
-        case 6:
-            // 0x8XY6: sets VX >>= 1, stores shifted bit into VF.
-            chip8->V[0xF] = chip8->V[chip8->inst.X] & 1;
-            chip8->V[chip8->inst.X] >>= 1;
+    chip8_state_t state = CHIP8_RUNNING;
+    const uint32_t start_ticks = SDL_GetTicks();
+    uint32_t frame = 0;
+    uint64_t busy_counts = 0;  // time spent emulating + drawing, excluding frame delay
+    uint64_t cell_uploads = 0;
 
-            break;
+    // Wall emulator loop
+    while (success && state != CHIP8_QUIT)
+    {
+        handleInput(&state);
+        const uint64_t frame_start = SDL_GetPerformanceCounter();
 
-        case 7:
-            // 0x8XY7: sets VX = VY - VX, set VF to 0 if borrow, and 1 when not
-            if (chip8->V[chip8->inst.X] > chip8->V[chip8->inst.Y])
-            {
-                chip8->V[0xF] = 0;
-                chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y] - chip8->V[chip8->inst.X];
-            }
-            else
+        for (uint32_t i = 0; i < config.wall_instances; i++)
+        {
+            chip8_t *chip8 = &machines[i];
+            if (state == CHIP8_RUNNING && chip8->state == CHIP8_RUNNING)
             {
-                chip8->V[0xF] = 1;
-                chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y] - chip8->V[chip8->inst.X];
+                chip8_run_frames(chip8, 1);
+                if (chip8->fault != CHIP8_FAULT_NONE)
+                    SDL_Log("Machine %u (%s) stopped at 0x%04X: %s\n",
+                            i, chip8->rom_name, chip8->PC, chip8_fault_name(chip8->fault));
             }
-            break;
-
-        case 0xE:
-            // 0x8XYE: sets VX <<= 1, stores shifted bit into VF.
-            chip8->V[0xF] = (chip8->V[chip8->inst.X] & 0x80) >> 7;
-            chip8->V[chip8->inst.X] <<= 1;
-            break;
 
-        default:
-            break; // wrong op code
+            // upload only cells whose display changed
+            cell_uploads += updateWallCell(texture, atlas, config, chip8, i);
         }
 
-        break;
+        // draw whole wall in one copy
+        SDL_RenderCopy(sdl.renderer, texture, NULL, NULL);
+        SDL_RenderPresent(sdl.renderer);
+        busy_counts += SDL_GetPerformanceCounter() - frame_start;
 
-    case 0x09:
-        // 0x9XY0: skip next instruction if VX != VY
-        if (chip8->inst.N != 0)
-        {
-            break; // wrong opcode
-        }
-        if (chip8->V[chip8->inst.X] != chip8->V[chip8->inst.Y])
-        {
-            chip8->PC += 2; // skip next op code.
-        }
-        break;
-
-    case 0x0A:
-        // 0xANNN: set index register I to NNN
-        chip8->I = chip8->inst.NNN;
-        break;
-
-    case 0x0D:
-        // 0xDXYN: Draw sprite at coordinate (VX, VY), read from memory location I
-        // sprite width 8, height N
-        // screen pixels are XOR'd with sprite bits
-        // VF (carry flag) set if any screen pixels are set off. Important for collision detection etc.
-        uint8_t X_pos = chip8->V[chip8->inst.X] % config.window_width;
-        uint8_t Y_pos = chip8->V[chip8->inst.Y] % config.window_height;
-        const uint8_t X_origin = X_pos;
-
-        chip8->V[0xF] = 0; // init carry flag to 0.
-
-        // loop over all N rows of sprite
-        for (uint8_t i = 0; i < (chip8->inst.N); i++)
-        {
-            // get next byte
-            const uint8_t sprite_data = chip8->ram[chip8->I + i];
-            X_pos = X_origin; // reset X to draw next row
+        // Delay for 60FPS, minus time spent this frame.
+        const uint32_t elapsed = SDL_GetTicks() - start_ticks;
+        const uint32_t next_frame = (uint32_t)(++frame * 1000ull / 60);
+        if (next_frame > elapsed)
+            SDL_Delay(next_frame - elapsed);
+    }
 
-            for (int8_t j = 7; j >= 0; j--)
-            {
-                // if sprite pixel bit is on and display pixel is on, set carry flag.
-                bool *pixel = &chip8->display[Y_pos * config.window_width + X_pos];
-                const bool sprite_bit = (sprite_data & (1 << j));
-                if (sprite_bit && *pixel)
-                {
-                    chip8->V[0xF] = 1;
-                }
+    // Report frame cost, to check the wall keeps up with 60FPS.
+    if (frame > 0)
+        SDL_Log("Wall view: %u machines, %u frames, %.3f ms busy per frame (16.667 budget), %.1f cell uploads per frame\n",
+                config.wall_instances, frame, busy_counts * 1000.0 / SDL_GetPerformanceFrequency() / frame,
+                (double)cell_uploads / frame);
 
-                // XOR display pixel with sprite pixel/bit to set it on or off
-                *pixel ^= sprite_bit;
+    if (texture)
+        SDL_DestroyTexture(texture);
+    free(atlas);
+    free(machines);
 
-                // stop drawing if hit right edge of screen
-                if (++X_pos >= config.window_width)
-                    break;
-            }
-            // stop drawing whole sprite if at bottom edge of screen
-            if (++Y_pos >= config.window_height)
-                break;
-        }
-        break;
-
-    default:
-        break; // invalid opcode
-    }
+    return success;
 }
 
 // MAIN FUNC
@@ -690,7 +408,9 @@ int main(int argc, char **argv)
     // default usage message for args
     if (argc < 2)
     {
-        fprintf(stderr, "\nNo ROM selected.\nCorrect Usage: %s <rom_name>\n\n", argv[0]);
+        fprintf(stderr, "\nNo ROM selected.\nCorrect Usage: %s <rom_name>\n"
+                        "               %s --wall <instances> <rom_name>...\n\n",
+                argv[0], argv[0]);
         exit(EXIT_FAILURE);
     }
 
@@ -698,6 +418,8 @@ int main(int argc, char **argv)
     config_t config = {0};
     if (!setConfig_Args(&config, argc, argv))
     {
+        fprintf(stderr, "\nInvalid arguments.\nCorrect Usage: %s --wall <instances 1-%u> <rom_name>...\n\n",
+                argv[0], WALL_MAX_INSTANCES);
         exit(EXIT_FAILURE);
     };
 
@@ -708,9 +430,17 @@ int main(int argc, char **argv)
         exit(EXIT_FAILURE);
     };
 
+    // Wall view: many machines in one window.
+    if (config.wall_instances)
+    {
+        const bool success = runWall(sdl, config);
+        finalCleanUp(&sdl);
+        exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
     // Initialise CHIP-8 machine.
     chip8_t chip8 = {0};
-    const char *rom_name = argv[1];
+    const char *rom_name = config.rom_names[0];
     if (!initCHIP(&chip8, rom_name))
         exit(EXIT_FAILURE);
 
@@ -718,18 +448,18 @@ int main(int argc, char **argv)
     clearWindow(sdl, config);
 
     // Main emulator loop
-    while (chip8.state != QUIT)
+    while (chip8.state != CHIP8_QUIT)
     {
         // Handle user inputs.
-        handleInput(&chip8);
+        handleInput(&chip8.state);
 
         // if paused continue.
-        if (chip8.state == PAUSED)
+        if (chip8.state == CHIP8_PAUSED)
             continue;
 
         // Get time()
         // Emulate CHIP8 instructions
-        emulateInstructions(&chip8, config);
+        chip8_step(&chip8, 1);
         // Get time changed from last get time()
 
         // Delay for 60FPS!
@@ -738,6 +468,10 @@ int main(int argc, char **argv)
         updateScreen(sdl, config, chip8);
     }
 
+    // Report if ROM stopped the machine with a fault.
+    if (chip8.fault != CHIP8_FAULT_NONE)
+        SDL_Log("ROM %s stopped at 0x%04X: %s\n", chip8.rom_name, chip8.PC, chip8_fault_name(chip8.fault));
+
     // Final cleanup before interpreter exit.
     finalCleanUp(&sdl);
 
@@ -0,0 +1,702 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "chip8_core.h"
+
+static void emulateInstructions(chip8_t *chip8);
+
+// Allocate a zeroed machine.
+chip8_t *chip8_create(void)
+{
+    chip8_t *chip8 = calloc(1, sizeof *chip8);
+    if (!chip8)
+        return NULL;
+
+    chip8_reset(chip8);
+    return chip8;
+}
+
+// Free machine.
+void chip8_destroy(chip8_t *chip8)
+{
+    free(chip8);
+}
+
+// Reset machine to power-on state.
+void chip8_reset(chip8_t *chip8)
+{
+    const uint8_t font[] = {
+        0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
+        0x20, 0x60, 0x20, 0x20, 0x70, // 1
+        0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
+        0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
+        0x90, 0x90, 0xF0, 0x10, 0x10, // 4
+        0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
+        0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
+        0xF0, 0x10, 0x20, 0x40, 0x40, // 7
+        0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
+        0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
+        0xF0, 0x90, 0xF0, 0x90, 0x90, // A
+        0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
+        0xF0, 0x80, 0x80, 0x80, 0xF0, // C
+        0xE0, 0x90, 0x90, 0x90, 0xE0, // D
+        0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
+        0xF0, 0x80, 0xF0, 0x80, 0x80  // F
+    };
+
+    // keep host settings across resets
+    const uint32_t insts_per_frame = chip8->insts_per_frame
+                                         ? chip8->insts_per_frame
+                                         : CHIP8_DEFAULT_INSTS_PER_FRAME;
+    uint8_t *const edge_map = chip8->edge_map;
+
+    memset(chip8, 0, sizeof *chip8);
+
+    // load font
+    memcpy(&chip8->ram[0], font, sizeof(font));
+
+    // set machine defaults
+    chip8->state = CHIP8_RUNNING;
+    chip8->PC = CHIP8_ENTRY_POINT;
+    chip8->insts_per_frame = insts_per_frame;
+    chip8->edge_map = edge_map;
+    chip8->prev_PC = CHIP8_ENTRY_POINT;
+    chip8->dirty_rows = UINT32_MAX; // whole display is new
+}
+
+// Reset machine and load rom image.
+bool chip8_load_rom_from_memory(chip8_t *chip8, const uint8_t *rom, size_t rom_size)
+{
+    const size_t max_size = sizeof chip8->ram - CHIP8_ENTRY_POINT;
+    if (rom_size > max_size)
+        return false;
+
+    chip8_reset(chip8);
+    memcpy(&chip8->ram[CHIP8_ENTRY_POINT], rom, rom_size);
+
+    return true; // Success.
+}
+
+// Execute up to n_cycles instructions.
+uint32_t chip8_step(chip8_t *chip8, uint32_t n_cycles)
+{
+    uint32_t executed = 0;
+    while (executed < n_cycles && chip8->state == CHIP8_RUNNING)
+    {
+        emulateInstructions(chip8);
+        executed++;
+    }
+
+    return executed;
+}
+
+// Run n_frames 60hz frames.
+uint32_t chip8_run_frames(chip8_t *chip8, uint32_t n_frames)
+{
+    uint32_t frames = 0;
+    while (frames < n_frames && chip8->state == CHIP8_RUNNING)
+    {
+        chip8_step(chip8, chip8->insts_per_frame);
+
+        // timers tick once per frame
+        if (chip8->delay_timer > 0)
+            chip8->delay_timer--;
+        if (chip8->sound_timer > 0)
+            chip8->sound_timer--;
+
+        frames++;
+    }
+
+    return frames;
+}
+
+// Rows changed since last call.
+uint32_t chip8_take_dirty_rows(chip8_t *chip8)
+{
+    const uint32_t dirty_rows = chip8->dirty_rows;
+    chip8->dirty_rows = 0;
+    return dirty_rows;
+}
+
+// Fault descriptions.
+const char *chip8_fault_name(chip8_fault_t fault)
+{
+    switch (fault)
+    {
+    case CHIP8_FAULT_NONE:
+        return "none";
+    case CHIP8_FAULT_STACK_OVERFLOW:
+        return "stack overflow";
+    case CHIP8_FAULT_STACK_UNDERFLOW:
+        return "stack underflow";
+    case CHIP8_FAULT_RAM_OOB:
+        return "out of bounds ram read";
+    case CHIP8_FAULT_PC_OOB:
+        return "program counter out of bounds";
+    }
+    return "unknown";
+}
+
+// Stop machine on a fault, leaving PC at the faulting instruction.
+static void raiseFault(chip8_t *chip8, const chip8_fault_t fault)
+{
+    if (fault != CHIP8_FAULT_PC_OOB)
+        chip8->PC -= 2; // instruction was fetched, undo pre-increment
+
+    chip8->fault = fault;
+    chip8->state = CHIP8_QUIT;
+}
+
+// Framebuffer pointer.
+const bool *chip8_display(const chip8_t *chip8)
+{
+    return chip8->display;
+}
+
+// Keypad pointer.
+bool *chip8_keypad(chip8_t *chip8)
+{
+    return chip8->keypad;
+}
+
+#ifdef DEBUG
+static void print_debug_info(chip8_t *chip8)
+{
+    printf("Address: 0x%04X | OpCode:0x%04X\nDesc: ",
+           chip8->PC - 2, chip8->inst.opcode);
+    switch ((chip8->inst.opcode >> 12) & 0x0F)
+    {
+    case 0x00:
+        // subroutine at NN
+        if (chip8->inst.NN == 0xE0)
+        {
+            // 0x00E0: clear screen
+            printf("Clear screen\n\n");
+        }
+        else if (chip8->inst.NN == 0xEE)
+        {
+            // 0x00EE: return from subroutine
+            // set program counter to last address on stack ("pop from stack")
+            //  so next opcode will be pulled from that address
+            printf("Return from subroutine to a new address 0x%04X\n\n",
+                   chip8->SP > 0 ? chip8->stack[chip8->SP - 1] : 0);
+        }
+        else
+        {
+            printf("Unimplemented OpCode.\n\n");
+        }
+        break;
+    case 0x01:
+        // 0x1NNN: jumps to address NNN
+        printf("Jump to address NNN (0x%04X)\n\n", chip8->inst.NNN);
+        break;
+    case 0x02:
+        // 0x2NNN: call subroutine at NNN
+        printf("Call subroutine at NNN (0x%04X)\n\n", chip8->inst.NNN);
+        break;
+    case 0x03:
+        // 0x3XNN: skip next instruction if VX == NN
+        printf("Check if V%X (0x%02X) == NN (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN);
+        break;
+    case 0x04:
+        // 0x4XNN: skip next instruction if VX != NN
+        printf("Check if V%X (0x%02X) != NN (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN);
+        break;
+    case 0x05:
+        // 0x5XY0: skip next instruction if VX == NN
+        printf("Check if V%X (0x%02X) == V%X (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y]);
+        break;
+    case 0x06:
+        // 0x6XNN: sets VX to NN
+        printf("Set register V%X to NN (0x%02X)\n\n", chip8->inst.X, chip8->inst.NN);
+        break;
+    case 0x07:
+        // 0x7XNN: sets VX += NN
+        printf("Set register V%X (0x%02X) to += NN (0x%02X). Result: %02X\n\n",
+               chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.NN, chip8->V[chip8->inst.X] + chip8->inst.NN);
+        break;
+    case 0x08:
+        switch (chip8->inst.N)
+        {
+        case 0:
+            // 0x8XY0: sets VX = VY
+            printf("Set register V%X = V%X (0x%02X)\n\n",
+                   chip8->inst.X, chip8->inst.Y, chip8->V[chip8->inst.Y]);
+            break;
+        case 1:
+            // 0x8XY1: sets VX |= VY
+            printf("Set register V%X (0x%02X) |= V%X (0x%02X). Result: 0x%02X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] | chip8->V[chip8->inst.Y]);
+            break;
+        case 2:
+            // 0x8XY2: sets VX &= VY
+            printf("Set register V%X (0x%02X) &= V%X (0x%02X). Result: 0x%02X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] & chip8->V[chip8->inst.Y]);
+            break;
+        case 3:
+            // 0x8XY3: sets VX ^= VY
+            printf("Set register V%X (0x%02X) ^= V%X (0x%02X). Result: 0x%02X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] ^ chip8->V[chip8->inst.Y]);
+            break;
+        case 4:
+            // 0x8XY4: sets VX += VY, set VF to 1 if carry, and 0 when not
+            printf("Set register V%X (0x%02X) += V%X (0x%02X), VF = 1 if carry. Result: 0x%02X, VF = %X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y],
+                   ((uint16_t)(chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y]) > 255));
+            break;
+        case 5:
+            // 0x8XY5: sets VX -= VY, set VF to 0 if borrow, and 1 when not
+            printf("Set register V%X (0x%02X) -= V%X (0x%02X), VF = 0 if borrow. Result: 0x%02X, VF = %X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] - chip8->V[chip8->inst.Y],
+                   (chip8->V[chip8->inst.X] <= chip8->V[chip8->inst.Y]));
+            break;
+        case 6:
+            // 0x8XY6: sets VX >>= 1, stores shifted bit into VF.
+            printf("Set register V%X (0x%02X) >>= 1, VF = shifted bit. Result: 0x%02X, VF = %X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->V[chip8->inst.X] >> 1,
+                   chip8->V[chip8->inst.X] & 1);
+            break;
+        case 7:
+            // 0x8XY7: sets VX = VY - VX, set VF to 0 if borrow, and 1 when not
+            printf("Set register V%X = V%X (0x%02X) - V%X (0x%02X), VF = 0 if borrow. Result: 0x%02X, VF = %X\n\n",
+                   chip8->inst.X,
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->inst.Y, chip8->V[chip8->inst.Y],
+                   chip8->V[chip8->inst.X] - chip8->V[chip8->inst.Y],
+                   (chip8->V[chip8->inst.Y] <= chip8->V[chip8->inst.X]));
+            break;
+        case 0xE:
+            // 0x8XYE: sets VX <<= 1, stores shifted bit into VF.
+            printf("Set register V%X (0x%02X) <<= 1, VF = shifted bit. Result: 0x%02X, VF = %X\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X],
+                   chip8->V[chip8->inst.X] << 1,
+                   (chip8->V[chip8->inst.X] & 0x80) >> 7);
+            break;
+        }
+        break;
+    case 0x09:
+        // 0x9XY0: skip next instruction if VX != NN
+        printf("Check if V%X (0x%02X) != V%X (0x%02X). Skip next instruction if true.\n\n", chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y]);
+        break;
+    case 0x0A:
+        // 0xANNN: set index register I to NNN
+        printf("Set index register I to NNN (0x%04X)\n\n", chip8->inst.NNN);
+        break;
+    case 0x0D:
+        // 0xDXYN: Draw sprite at coordinate (VX, VY), read from memory location I
+        // sprite width 8, height N
+        // screen pixels are XOR'd with sprite bits
+        // VF (carry flag) set if any screen pixels are set off. Important for collision detection etc.
+        printf("Drawing N (%u) height sprite at coords V%X (0x%02X), V%X (0x%02X) "
+               "from memory location I (0x%04X).\nSet VF = 1 if any pixels are off.\n\n",
+               chip8->inst.N, chip8->inst.X, chip8->V[chip8->inst.X], chip8->inst.Y, chip8->V[chip8->inst.Y], chip8->I);
+        break;
+    case 0x0E:
+        if (chip8->inst.NN == 0x9E)
+        {
+            // 0xEX9E: skip next instruction if key VX is pressed
+            printf("Skip next instruction if key in V%X (0x%02X) is pressed. Keypad value: %d\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X], chip8->keypad[chip8->V[chip8->inst.X] & 0x0F]);
+        }
+        else if (chip8->inst.NN == 0xA1)
+        {
+            // 0xEXA1: skip next instruction if key VX is not pressed
+            printf("Skip next instruction if key in V%X (0x%02X) is not pressed. Keypad value: %d\n\n",
+                   chip8->inst.X, chip8->V[chip8->inst.X], chip8->keypad[chip8->V[chip8->inst.X] & 0x0F]);
+        }
+        else
+        {
+            printf("Unimplemented OpCode.\n\n");
+        }
+        break;
+    case 0x0F:
+        switch (chip8->inst.NN)
+        {
+        case 0x07:
+            // 0xFX07: sets VX = delay timer
+            printf("Set V%X = delay timer (0x%02X)\n\n", chip8->inst.X, chip8->delay_timer);
+            break;
+        case 0x0A:
+            // 0xFX0A: wait for a key to be pressed and released, store key in VX
+            printf("Wait for key press and release, store key in V%X\n\n", chip8->inst.X);
+            break;
+        case 0x15:
+            // 0xFX15: sets delay timer = VX
+            printf("Set delay timer = V%X (0x%02X)\n\n", chip8->inst.X, chip8->V[chip8->inst.X]);
+            break;
+        case 0x18:
+            // 0xFX18: sets sound timer = VX
+            printf("Set sound timer = V%X (0x%02X)\n\n", chip8->inst.X, chip8->V[chip8->inst.X]);
+            break;
+        default:
+            printf("Unimplemented OpCode.\n\n");
+            break;
+        }
+        break;
+    default:
+        printf("Unimplemented OpCode.\n\n");
+        break; // invalid opcode
+    }
+};
+#endif
+
+// Emulate chip8 instructions:
+static void emulateInstructions(chip8_t *chip8)
+{
+    if (chip8->PC > sizeof chip8->ram - 2)
+    {
+        raiseFault(chip8, CHIP8_FAULT_PC_OOB);
+        return;
+    }
+
+    // record PC transition in coverage map, hashed to 16 bits
+    if (chip8->edge_map)
+    {
+        const uint32_t edge = ((uint32_t)chip8->prev_PC << 12 | chip8->PC) * 2654435761u;
+        uint8_t *hits = &chip8->edge_map[edge >> 16];
+        *hits += 1 + (*hits == UINT8_MAX); // never wrap to 0 (no coverage), as AFL's NeverZero
+        chip8->prev_PC = chip8->PC;
+    }
+
+    // get next opcode from ram
+    chip8->inst.opcode = chip8->ram[chip8->PC] << 8 | chip8->ram[chip8->PC + 1];
+    chip8->PC += 2; // pre-increment pc to get next op code
+
+    // fill out current instruction format
+    //  DXYN
+    chip8->inst.NNN = chip8->inst.opcode & 0x0FFF;
+    chip8->inst.NN = chip8->inst.opcode & 0x0FF;
+    chip8->inst.N = chip8->inst.opcode & 0x0F;
+    chip8->inst.X = (chip8->inst.opcode >> 8) & 0x0F;
+    chip8->inst.Y = (chip8->inst.opcode >> 4) & 0x0F;
+
+#ifdef DEBUG
+    print_debug_info(chip8);
+#endif
+
+    // emulate opcode
+    switch ((chip8->inst.opcode >> 12) & 0x0F)
+    {
+    case 0x00:
+        // subroutine at NN
+        if (chip8->inst.NN == 0xE0)
+        {
+            // 0x00E0: clear screen
+            memset(chip8->display, false, sizeof chip8->display);
+            chip8->dirty_rows = UINT32_MAX;
+        }
+        else if (chip8->inst.NN == 0xEE)
+        {
+            // 0x00EE: return from subroutine
+            // set program counter to last address on stack ("pop from stack")
+            //  so next opcode will be pulled from that address
+            if (chip8->SP == 0)
+            {
+                raiseFault(chip8, CHIP8_FAULT_STACK_UNDERFLOW);
+                break;
+            }
+            chip8->PC = chip8->stack[--chip8->SP];
+        }
+        else
+        {
+            // Unimplemented/invalid opcode, may be 0xNNN for calling machine code routine for RCA1802
+        }
+        break;
+
+    case 0x01:
+        // 0x1NNN: jumps to address NNN
+        chip8->PC = chip8->inst.NNN; // set program counter so next opcode is from NNN.
+        break;
+
+    case 0x02:
+        // 0x2NNN: call subroutine at NNN
+        if (chip8->SP == sizeof chip8->stack / sizeof chip8->stack[0])
+        {
+            raiseFault(chip8, CHIP8_FAULT_STACK_OVERFLOW);
+            break;
+        }
+        chip8->stack[chip8->SP++] = chip8->PC; // store current address to return to on subroutine stack ("push on stack")
+        chip8->PC = chip8->inst.NNN;           // set program counter to subroutine address to pull next opcode.
+        break;
+
+    case 0x03:
+        // 0x3XNN: skip next instruction if VX == NN
+        if (chip8->V[chip8->inst.X] == chip8->inst.NN)
+        {
+            chip8->PC += 2; // skip next op code.
+        }
+        break;
+
+    case 0x04:
+        // 0x4XNN: skip next instruction if VX != NN
+        if (chip8->V[chip8->inst.X] != chip8->inst.NN)
+        {
+            chip8->PC += 2; // skip next op code.
+        }
+        break;
+
+    case 0x05:
+        // 0x5XY0: skip next instruction if VX == VY
+        if (chip8->inst.N != 0)
+        {
+            break; // wrong opcode
+        }
+        if (chip8->V[chip8->inst.X] == chip8->V[chip8->inst.Y])
+        {
+            chip8->PC += 2; // skip next op code.
+        }
+        break;
+
+    case 0x06:
+        // 0x6XNN: sets VX to NN
+        chip8->V[chip8->inst.X] = chip8->inst.NN;
+        break;
+
+    case 0x07:
+        // 0x7XNN: sets register VX += NN
+        chip8->V[chip8->inst.X] += chip8->inst.NN;
+        break;
+
+    case 0x08:
+
+        switch (chip8->inst.N)
+        {
+        case 0:
+            // 0x8XY0: sets VX = VY
+            chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y];
+            break;
+
+        case 1:
+            // 0x8XY1: sets VX |= VY
+            chip8->V[chip8->inst.X] |= chip8->V[chip8->inst.Y];
+            break;
+
+        case 2:
+            // 0x8XY2: sets VX &= VY
+            chip8->V[chip8->inst.X] &= chip8->V[chip8->inst.Y];
+            break;
+
+        case 3:
+            // 0x8XY3: sets VX ^= VY
+            chip8->V[chip8->inst.X] ^= chip8->V[chip8->inst.Y];
+            break;
+
+        case 4:
+            // 0x8XY4: sets VX += VY, set VF to 1 if carry, and 0 when not
+            if ((uint16_t)(chip8->V[chip8->inst.X] + chip8->V[chip8->inst.Y]) > 255)
+            {
+                chip8->V[0xF] = 1;
+                chip8->V[chip8->inst.X] += chip8->V[chip8->inst.Y];
+            }
+            else
+            {
+                chip8->V[0xF] = 0;
+                chip8->V[chip8->inst.X] += chip8->V[chip8->inst.Y];
+            };
+            break;
+
+        case 5:
+            // 0x8XY5: sets VX -= VY, set VF to 0 if borrow, and 1 when not
+            if (chip8->V[chip8->inst.Y] > chip8->V[chip8->inst.X])
+            {
+                chip8->V[0xF] = 0;
+                chip8->V[chip8->inst.X] -= chip8->V[chip8->inst.Y];
+            }
+            else
+            {
+                chip8->V[0xF] = 1;
+                chip8->V[chip8->inst.X] -= chip8->V[chip8->inst.Y];
+            }
+            break;
+
+        case 6:
+            // 0x8XY6: sets VX >>= 1, stores shifted bit into VF.
+            chip8->V[0xF] = chip8->V[chip8->inst.X] & 1;
+            chip8->V[chip8->inst.X] >>= 1;
+
+            break;
+
+        case 7:
+            // 0x8XY7: sets VX = VY - VX, set VF to 0 if borrow, and 1 when not
+            if (chip8->V[chip8->inst.X] > chip8->V[chip8->inst.Y])
+            {
+                chip8->V[0xF] = 0;
+                chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y] - chip8->V[chip8->inst.X];
+            }
+            else
+            {
+                chip8->V[0xF] = 1;
+                chip8->V[chip8->inst.X] = chip8->V[chip8->inst.Y] - chip8->V[chip8->inst.X];
+            }
+            break;
+
+        case 0xE:
+            // 0x8XYE: sets VX <<= 1, stores shifted bit into VF.
+            chip8->V[0xF] = (chip8->V[chip8->inst.X] & 0x80) >> 7;
+            chip8->V[chip8->inst.X] <<= 1;
+            break;
+
+        default:
+            break; // wrong op code
+        }
+
+        break;
+
+    case 0x09:
+        // 0x9XY0: skip next instruction if VX != VY
+        if (chip8->inst.N != 0)
+        {
+            break; // wrong opcode
+        }
+        if (chip8->V[chip8->inst.X] != chip8->V[chip8->inst.Y])
+        {
+            chip8->PC += 2; // skip next op code.
+        }
+        break;
+
+    case 0x0A:
+        // 0xANNN: set index register I to NNN
+        chip8->I = chip8->inst.NNN;
+        break;
+
+    case 0x0D:
+        // 0xDXYN: Draw sprite at coordinate (VX, VY), read from memory location I
+        // sprite width 8, height N
+        // screen pixels are XOR'd with sprite bits
+        // VF (carry flag) set if any screen pixels are set off. Important for collision detection etc.
+        if (chip8->I + chip8->inst.N > sizeof chip8->ram)
+        {
+            raiseFault(chip8, CHIP8_FAULT_RAM_OOB);
+            break;
+        }
+
+        uint8_t X_pos = chip8->V[chip8->inst.X] % CHIP8_DISPLAY_WIDTH;
+        uint8_t Y_pos = chip8->V[chip8->inst.Y] % CHIP8_DISPLAY_HEIGHT;
+        const uint8_t X_origin = X_pos;
+
+        chip8->V[0xF] = 0; // init carry flag to 0.
+
+        // loop over all N rows of sprite
+        for (uint8_t i = 0; i < (chip8->inst.N); i++)
+        {
+            // get next byte
+            const uint8_t sprite_data = chip8->ram[chip8->I + i];
+            X_pos = X_origin; // reset X to draw next row
+            if (sprite_data)
+                chip8->dirty_rows |= 1u << Y_pos;
+
+            for (int8_t j = 7; j >= 0; j--)
+            {
+                // if sprite pixel bit is on and display pixel is on, set carry flag.
+                bool *pixel = &chip8->display[Y_pos * CHIP8_DISPLAY_WIDTH + X_pos];
+                const bool sprite_bit = (sprite_data & (1 << j));
+                if (sprite_bit && *pixel)
+                {
+                    chip8->V[0xF] = 1;
+                }
+
+                // XOR display pixel with sprite pixel/bit to set it on or off
+                *pixel ^= sprite_bit;
+
+                // stop drawing if hit right edge of screen
+                if (++X_pos >= CHIP8_DISPLAY_WIDTH)
+                    break;
+            }
+            // stop drawing whole sprite if at bottom edge of screen
+            if (++Y_pos >= CHIP8_DISPLAY_HEIGHT)
+                break;
+        }
+        break;
+
+    case 0x0E:
+        if (chip8->inst.NN == 0x9E)
+        {
+            // 0xEX9E: skip next instruction if key VX is pressed
+            if (chip8->keypad[chip8->V[chip8->inst.X] & 0x0F])
+                chip8->PC += 2; // skip next op code.
+        }
+        else if (chip8->inst.NN == 0xA1)
+        {
+            // 0xEXA1: skip next instruction if key VX is not pressed
+            if (!chip8->keypad[chip8->V[chip8->inst.X] & 0x0F])
+                chip8->PC += 2; // skip next op code.
+        }
+        break;
+
+    case 0x0F:
+        switch (chip8->inst.NN)
+        {
+        case 0x07:
+            // 0xFX07: sets VX = delay timer
+            chip8->V[chip8->inst.X] = chip8->delay_timer;
+            break;
+
+        case 0x0A:
+            // 0xFX0A: wait for a key to be pressed and released, store key in VX
+            if (!chip8->key_wait)
+            {
+                // start waiting: keys already held don't count
+                chip8->key_wait = true;
+                chip8->wait_key = -1;
+                memcpy(chip8->prev_keypad, chip8->keypad, sizeof chip8->keypad);
+            }
+
+            if (chip8->wait_key < 0)
+            {
+                // look for a newly pressed key
+                for (uint8_t key = 0; key < sizeof chip8->keypad; key++)
+                {
+                    if (chip8->keypad[key] && !chip8->prev_keypad[key])
+                    {
+                        chip8->wait_key = key;
+                        break;
+                    }
+                }
+                memcpy(chip8->prev_keypad, chip8->keypad, sizeof chip8->keypad);
+            }
+
+            if (chip8->wait_key >= 0 && !chip8->keypad[chip8->wait_key])
+            {
+                // pressed key released, done
+                chip8->V[chip8->inst.X] = chip8->wait_key;
+                chip8->key_wait = false;
+            }
+            else
+            {
+                chip8->PC -= 2; // keep waiting, run this op code again.
+            }
+            break;
+
+        case 0x15:
+            // 0xFX15: sets delay timer = VX
+            chip8->delay_timer = chip8->V[chip8->inst.X];
+            break;
+
+        case 0x18:
+            // 0xFX18: sets sound timer = VX
+            chip8->sound_timer = chip8->V[chip8->inst.X];
+            break;
+
+        default:
+            break; // unimplemented opcode
+        }
+        break;
+
+    default:
+        break; // invalid opcode
+    }
+}
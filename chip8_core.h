@@ -0,0 +1,113 @@
+#ifndef CHIP8_CORE_H
+#define CHIP8_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// CHIP-8 interpreter core. Has no SDL dependency so it can be built as libchip8
+// and embedded in other programs (see `make lib`).
+
+#define CHIP8_DISPLAY_WIDTH 64            // original chip8 X resolution
+#define CHIP8_DISPLAY_HEIGHT 32           // original chip8 Y resolution
+#define CHIP8_ENTRY_POINT 0x200           // roms loaded to 0x200
+#define CHIP8_DEFAULT_INSTS_PER_FRAME 11  // ~700 instructions per second at 60hz
+#define CHIP8_EDGE_MAP_SIZE (1 << 16)     // bytes in a coverage edge map
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Emulator states.
+typedef enum
+{
+    CHIP8_QUIT,
+    CHIP8_RUNNING,
+    CHIP8_PAUSED,
+} chip8_state_t;
+
+// Machine faults. The faulting instruction is not executed, the machine stops (state CHIP8_QUIT)
+// and PC is left at the faulting instruction.
+typedef enum
+{
+    CHIP8_FAULT_NONE,
+    CHIP8_FAULT_STACK_OVERFLOW,  // 2NNN with all 12 stack entries used
+    CHIP8_FAULT_STACK_UNDERFLOW, // 00EE with an empty stack
+    CHIP8_FAULT_RAM_OOB,         // DXYN sprite read past end of ram (I + N > 4096)
+    CHIP8_FAULT_PC_OOB,          // opcode fetch past end of ram
+} chip8_fault_t;
+
+typedef struct
+{
+    uint16_t opcode;
+    uint16_t NNN; // 12 bit address
+    uint8_t NN;   // 8 bit address
+    uint8_t N;    // 4 bit address
+    uint8_t X;    // 4 bit register identifier
+    uint8_t Y;    // 4 bit register identifier
+} chip8_instruction_t;
+
+// CHIP-8 machine struct. Holds no pointers into itself, so it can be copied for snapshots.
+typedef struct
+{
+    chip8_state_t state;
+    uint8_t ram[4096];
+    bool display[CHIP8_DISPLAY_WIDTH * CHIP8_DISPLAY_HEIGHT]; // original chip8 resolution
+    uint16_t stack[12];       // subroutine stack
+    uint8_t SP;               // stack index, next free stack entry
+    uint8_t V[16];            // data registers V0-VF
+    uint16_t I;               // index registers
+    uint16_t PC;              // program counter
+    uint8_t delay_timer;      // decrements at 60hz when > 0
+    uint8_t sound_timer;      // decrements at 60hz and plays tone when > 0
+    bool keypad[16];          // hexadecimal keypad 0x0 - 0xF
+    bool prev_keypad[16];     // keypad at last FX0A poll, to spot new presses
+    bool key_wait;            // FX0A waiting for a key press and release
+    int8_t wait_key;          // key pressed during FX0A, -1 if none yet
+    const char *rom_name;     // currently running ROM
+    chip8_instruction_t inst; // currently executing instruction
+    uint32_t insts_per_frame; // instructions executed per chip8_run_frames() frame
+    chip8_fault_t fault;      // set when the machine stops on a fault
+    uint8_t *edge_map;        // optional CHIP8_EDGE_MAP_SIZE coverage map, hit count per PC transition
+    uint16_t prev_PC;         // PC of previous instruction, for edge coverage
+    uint32_t dirty_rows;      // bit per display row changed by 00E0/DXYN, see chip8_take_dirty_rows()
+} chip8_t;
+
+// Allocate a zeroed machine. Returns NULL on allocation failure.
+chip8_t *chip8_create(void);
+
+// Free a machine returned by chip8_create().
+void chip8_destroy(chip8_t *chip8);
+
+// Reset machine to power-on state, clearing ram/display/registers and loading the font.
+void chip8_reset(chip8_t *chip8);
+
+// Reset machine and load a ROM image to the entry point. Returns false if the ROM does not fit.
+bool chip8_load_rom_from_memory(chip8_t *chip8, const uint8_t *rom, size_t rom_size);
+
+// Execute up to n_cycles instructions while the machine is CHIP8_RUNNING.
+// Returns the number of instructions actually executed.
+uint32_t chip8_step(chip8_t *chip8, uint32_t n_cycles);
+
+// Run n_frames 60hz frames: insts_per_frame instructions then a timer tick per frame.
+// Returns the number of frames completed.
+uint32_t chip8_run_frames(chip8_t *chip8, uint32_t n_frames);
+
+// Zero-copy access to the framebuffer: CHIP8_DISPLAY_WIDTH * CHIP8_DISPLAY_HEIGHT
+// bytes, row-major, one byte (0 or 1) per pixel.
+const bool *chip8_display(const chip8_t *chip8);
+
+// Zero-copy access to the 16 keypad bytes. Host writes 1 (pressed) or 0 (released).
+bool *chip8_keypad(chip8_t *chip8);
+
+// Return the bit per display row changed since the last call (bit 0 = top row), and clear it.
+uint32_t chip8_take_dirty_rows(chip8_t *chip8);
+
+// Short description of a fault, for reports.
+const char *chip8_fault_name(chip8_fault_t fault);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHIP8_CORE_H
@@ -0,0 +1,710 @@
+#define _DEFAULT_SOURCE // fork, mmap MAP_ANONYMOUS, strsignal
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "chip8_core.h"
+
+// Coverage-guided ROM + keypad input fuzzer. Headless, runs one worker process per core.
+// Each worker runs an in-process persistent loop: mutate a queued test case, run it on a
+// chip8_t with an edge map attached, keep it if it hits new PC transitions, save it if it faults.
+// If the interpreter itself crashes, the worker saves the input from its signal handler and the
+// parent restarts it.
+
+#define MAX_ROM_SIZE (4096 - CHIP8_ENTRY_POINT)
+#define MAX_FRAMES 600    // 10 seconds of keypad input
+#define SEED_FRAMES 120   // frames of (empty) input given to seed ROMs
+#define MAX_QUEUE 4096    // per worker queue entries
+#define HAVOC_ROUNDS 256  // mutations per queue entry before moving on
+#define CRASH_PCS 0x2000  // PCs a fault can be raised at (past end of ram included)
+#define SKIP_PERCENT 90   // chance to skip a queue entry that is not the smallest input for any edge
+#define MAX_RESTARTS 16   // times a crashed worker is restarted
+#define NO_ENTRY 0xFFFF   // top_rated value for edges without a queue entry
+#define TESTCASE_MAX_BYTES (4 + MAX_ROM_SIZE + 2 * MAX_FRAMES)
+
+// Test case: ROM image + keypad state (bit per key) for each frame.
+typedef struct
+{
+    uint16_t rom_size;
+    uint16_t n_frames;
+    uint8_t rom[MAX_ROM_SIZE];
+    uint16_t keys[MAX_FRAMES];
+} testcase_t;
+
+// Queue entry.
+typedef struct
+{
+    testcase_t tc;
+    uint32_t cost;     // serialized size, smaller entries are preferred per edge
+    uint32_t favoured; // edges this entry is the smallest input for
+    char name[32];     // file name in out_dir/queue, empty for seeds
+} queue_entry_t;
+
+// Per worker queue.
+typedef struct
+{
+    queue_entry_t *entries[MAX_QUEUE];
+    uint32_t len;
+    uint16_t top_rated[CHIP8_EDGE_MAP_SIZE]; // smallest entry hitting each edge, NO_ENTRY if none
+} queue_t;
+
+// State shared between all workers (anonymous shared mapping).
+typedef struct
+{
+    uint8_t virgin[CHIP8_EDGE_MAP_SIZE];                 // bucketed hit counts seen by any worker
+    uint8_t crash_seen[CHIP8_FAULT_PC_OOB + 1][CRASH_PCS]; // (fault, PC) pairs already saved
+    uint64_t execs;
+    uint64_t paths;
+    uint64_t crashes;
+    volatile sig_atomic_t stop;
+} shared_t;
+
+// Fuzzer configuration.
+typedef struct
+{
+    const char *out_dir;
+    uint32_t workers;
+    testcase_t *seeds;
+    uint32_t n_seeds;
+} fuzz_config_t;
+
+static shared_t *shared;
+
+// Hit count buckets: 1, 2-15, 16+. Coarser than AFL's, since runs last hundreds of frames and
+// loop counts vary between nearly every mutant.
+static uint8_t count_class[256];
+
+static void initCountClasses(void)
+{
+    for (uint32_t i = 1; i < 256; i++)
+        count_class[i] = i == 1 ? 1 : i < 16 ? 2 : 4;
+}
+
+// Test case being run, saved by handleFatalSignal() if the interpreter crashes.
+static const testcase_t *running;
+static char signal_crash_path[4096]; // out_dir/crashes/sig_wNN_pidNNN_ prefix, signal number appended
+static uint8_t signal_crash_buf[TESTCASE_MAX_BYTES];
+
+// xorshift64 per worker random number generator.
+static uint64_t rng_state;
+
+static uint32_t rnd(uint32_t limit)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32) % limit;
+}
+
+// Stop all workers on Ctrl-C.
+static void handleSignal(int sig)
+{
+    (void)sig;
+    shared->stop = true;
+}
+
+// Run a test case, filling trace with edge hit counts. Returns the fault the machine stopped on.
+static chip8_fault_t runTestcase(chip8_t *chip8, uint8_t *trace, const testcase_t *tc)
+{
+    running = tc;
+    memset(trace, 0, CHIP8_EDGE_MAP_SIZE);
+    chip8->edge_map = trace;
+    chip8_load_rom_from_memory(chip8, tc->rom, tc->rom_size);
+
+    bool *keypad = chip8_keypad(chip8);
+    for (uint32_t frame = 0; frame < tc->n_frames && chip8->state == CHIP8_RUNNING; frame++)
+    {
+        for (uint32_t key = 0; key < 16; key++)
+            keypad[key] = (tc->keys[frame] >> key) & 1;
+        chip8_run_frames(chip8, 1);
+    }
+
+    __atomic_fetch_add(&shared->execs, 1, __ATOMIC_RELAXED);
+    running = NULL;
+    return chip8->fault;
+}
+
+// Returns true if trace hits a hit count bucket not yet in virgin.
+static bool hasNewBits(const uint8_t *trace, const uint8_t *virgin)
+{
+    const uint64_t *words = (const uint64_t *)trace;
+
+    for (uint32_t w = 0; w < CHIP8_EDGE_MAP_SIZE / 8; w++)
+    {
+        if (!words[w])
+            continue; // most of the map is untouched
+
+        for (uint32_t i = w * 8; i < w * 8 + 8; i++)
+        {
+            if (count_class[trace[i]] & ~__atomic_load_n(&virgin[i], __ATOMIC_RELAXED))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Merge trace hit count buckets into virgin.
+static void mergeBits(const uint8_t *trace, uint8_t *virgin)
+{
+    const uint64_t *words = (const uint64_t *)trace;
+
+    for (uint32_t w = 0; w < CHIP8_EDGE_MAP_SIZE / 8; w++)
+    {
+        if (!words[w])
+            continue;
+
+        for (uint32_t i = w * 8; i < w * 8 + 8; i++)
+        {
+            if (trace[i])
+                __atomic_fetch_or(&virgin[i], count_class[trace[i]], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Serialize test case into buf, returning its length. Async signal safe.
+// Format: rom_size (u16 LE), n_frames (u16 LE), rom bytes, n_frames keypad masks (u16 LE).
+static size_t serializeTestcase(const testcase_t *tc, uint8_t *buf)
+{
+    size_t len = 0;
+    buf[len++] = tc->rom_size & 0xFF;
+    buf[len++] = tc->rom_size >> 8;
+    buf[len++] = tc->n_frames & 0xFF;
+    buf[len++] = tc->n_frames >> 8;
+    for (uint32_t i = 0; i < tc->rom_size; i++)
+        buf[len++] = tc->rom[i];
+    for (uint32_t frame = 0; frame < tc->n_frames; frame++)
+    {
+        buf[len++] = tc->keys[frame] & 0xFF;
+        buf[len++] = tc->keys[frame] >> 8;
+    }
+    return len;
+}
+
+// Save the running test case when the interpreter crashes, then die with the same signal.
+static void handleFatalSignal(int sig)
+{
+    if (running)
+    {
+        // append signal number to prebuilt path without stdio
+        char path[sizeof signal_crash_path + 4];
+        size_t len = strlen(signal_crash_path);
+        memcpy(path, signal_crash_path, len);
+        if (sig >= 10)
+            path[len++] = '0' + sig / 10;
+        path[len++] = '0' + sig % 10;
+        path[len] = '\0';
+
+        const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0)
+        {
+            const ssize_t written = write(fd, signal_crash_buf, serializeTestcase(running, signal_crash_buf));
+            (void)written;
+            close(fd);
+        }
+        __atomic_fetch_add(&shared->crashes, 1, __ATOMIC_RELAXED);
+    }
+
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+// Write test case to out_dir/sub_dir/name, in serializeTestcase() format.
+static bool saveTestcase(const testcase_t *tc, const char *out_dir, const char *sub_dir, const char *name)
+{
+    char path[4096];
+    snprintf(path, sizeof path, "%s/%s/%s", out_dir, sub_dir, name);
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Could not write %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    static uint8_t buf[TESTCASE_MAX_BYTES];
+    fwrite(buf, serializeTestcase(tc, buf), 1, file);
+    fclose(file);
+
+    return true;
+}
+
+// Read a test case written by saveTestcase().
+static bool loadTestcase(testcase_t *tc, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Test case %s is invalid or does not exist.\n", path);
+        return false;
+    }
+
+    uint8_t header[4];
+    bool ok = fread(header, sizeof header, 1, file) == 1;
+    memset(tc, 0, sizeof *tc);
+    tc->rom_size = header[0] | header[1] << 8;
+    tc->n_frames = header[2] | header[3] << 8;
+    ok = ok && tc->rom_size <= MAX_ROM_SIZE && tc->n_frames <= MAX_FRAMES;
+    ok = ok && (tc->rom_size == 0 || fread(tc->rom, tc->rom_size, 1, file) == 1);
+    for (uint32_t frame = 0; ok && frame < tc->n_frames; frame++)
+    {
+        uint8_t mask[2];
+        ok = fread(mask, sizeof mask, 1, file) == 1;
+        tc->keys[frame] = mask[0] | mask[1] << 8;
+    }
+    fclose(file);
+
+    if (!ok)
+        fprintf(stderr, "Could not read test case %s.\n", path);
+    return ok;
+}
+
+// Read a raw ROM file as a seed test case with no keypad input.
+static bool loadSeedRom(testcase_t *tc, const char *path)
+{
+    FILE *rom = fopen(path, "rb");
+    if (!rom)
+    {
+        fprintf(stderr, "ROM file %s is invalid or does not exist.\n", path);
+        return false;
+    }
+
+    memset(tc, 0, sizeof *tc);
+    tc->rom_size = fread(tc->rom, 1, MAX_ROM_SIZE, rom);
+    tc->n_frames = SEED_FRAMES;
+    fclose(rom);
+
+    return true;
+}
+
+// Apply a stack of random mutations to ROM bytes and keypad input.
+static void mutate(testcase_t *tc, const queue_t *queue)
+{
+    static const uint8_t interesting[] = {0x00, 0x01, 0x0F, 0x10, 0x7F, 0x80, 0xE0, 0xEE, 0xF0, 0xFF};
+    const uint32_t n_mutations = 1 << (1 + rnd(4));
+
+    for (uint32_t m = 0; m < n_mutations; m++)
+    {
+        if (tc->rom_size < 2)
+            tc->rom_size = 2;
+
+        switch (rnd(9))
+        {
+        case 0:
+            // flip a ROM bit
+            tc->rom[rnd(tc->rom_size)] ^= 1 << rnd(8);
+            break;
+        case 1:
+            // random ROM byte
+            tc->rom[rnd(tc->rom_size)] = rnd(256);
+            break;
+        case 2:
+            // interesting ROM byte
+            tc->rom[rnd(tc->rom_size)] = interesting[rnd(sizeof interesting)];
+            break;
+        case 3:
+            // random opcode, aligned to an instruction
+            {
+                const uint32_t pos = rnd(tc->rom_size / 2) * 2;
+                tc->rom[pos] = rnd(16) << 4 | rnd(16);
+                tc->rom[pos + 1] = rnd(256);
+            }
+            break;
+        case 4:
+            // copy a ROM chunk within itself
+            {
+                const uint32_t len = 1 + rnd(tc->rom_size < 32 ? tc->rom_size : 32);
+                const uint32_t from = rnd(tc->rom_size - len + 1);
+                const uint32_t to = rnd(tc->rom_size - len + 1);
+                memmove(&tc->rom[to], &tc->rom[from], len);
+            }
+            break;
+        case 5:
+            // grow or shrink the ROM
+            if (rnd(2) && tc->rom_size < MAX_ROM_SIZE - 2)
+                tc->rom_size += 2;
+            else if (tc->rom_size > 2)
+                tc->rom_size -= 2;
+            break;
+        case 6:
+            // hold a key over a range of frames
+            {
+                const uint32_t start = rnd(tc->n_frames);
+                const uint32_t len = 1 + rnd(30);
+                const uint16_t mask = 1 << rnd(16);
+                for (uint32_t frame = start; frame < start + len && frame < tc->n_frames; frame++)
+                    tc->keys[frame] ^= mask;
+            }
+            break;
+        case 7:
+            // lengthen or shorten the input
+            tc->n_frames = 1 + rnd(MAX_FRAMES);
+            break;
+        case 8:
+            // splice: take the ROM tail of another queue entry
+            {
+                const testcase_t *other = &queue->entries[rnd(queue->len)]->tc;
+                if (other->rom_size < 2)
+                    break;
+                const uint32_t split = rnd(other->rom_size);
+                memcpy(&tc->rom[split], &other->rom[split], other->rom_size - split);
+                tc->rom_size = other->rom_size;
+            }
+            break;
+        }
+    }
+}
+
+// Add test case to queue, taking over edges it is the smallest input for. When the queue is full it
+// replaces an entry that is not the smallest input for any edge. Returns false if nothing could be
+// replaced, in which case the test case is dropped.
+static bool queueTestcase(queue_t *queue, const testcase_t *tc, const uint8_t *trace,
+                          const char *out_dir, uint32_t worker_id, bool save)
+{
+    uint32_t slot = queue->len;
+    if (slot == MAX_QUEUE)
+    {
+        const uint32_t start = rnd(MAX_QUEUE);
+        for (uint32_t i = 0; i < MAX_QUEUE; i++)
+        {
+            const uint32_t candidate = (start + i) % MAX_QUEUE;
+            if (!queue->entries[candidate]->favoured)
+            {
+                slot = candidate;
+                break;
+            }
+        }
+        if (slot == MAX_QUEUE)
+            return false; // every entry is needed for some edge
+
+        // evicted entry's file goes too, so queue/ mirrors the in-memory queue
+        if (queue->entries[slot]->name[0])
+        {
+            char path[4096];
+            snprintf(path, sizeof path, "%s/queue/%s", out_dir, queue->entries[slot]->name);
+            unlink(path);
+        }
+    }
+    else
+    {
+        queue->entries[slot] = malloc(sizeof *queue->entries[slot]);
+        if (!queue->entries[slot])
+            return false;
+        queue->len++;
+    }
+
+    queue_entry_t *entry = queue->entries[slot];
+    static uint8_t buf[TESTCASE_MAX_BYTES];
+    entry->tc = *tc;
+    entry->cost = serializeTestcase(tc, buf);
+    entry->favoured = 0;
+    entry->name[0] = '\0';
+
+    // become top rated for edges where this is the smallest input so far
+    for (uint32_t i = 0; i < CHIP8_EDGE_MAP_SIZE; i++)
+    {
+        if (!trace[i])
+            continue;
+
+        const uint16_t top = queue->top_rated[i];
+        if (top == NO_ENTRY || queue->entries[top]->cost > entry->cost)
+        {
+            if (top != NO_ENTRY)
+                queue->entries[top]->favoured--;
+            queue->top_rated[i] = slot;
+            entry->favoured++;
+        }
+    }
+
+    if (save)
+    {
+        const uint64_t id = __atomic_fetch_add(&shared->paths, 1, __ATOMIC_RELAXED);
+        snprintf(entry->name, sizeof entry->name, "id_%06llu_w%02u", (unsigned long long)id, worker_id);
+        saveTestcase(tc, out_dir, "queue", entry->name);
+    }
+
+    return true;
+}
+
+// Fuzz loop for one worker process.
+static void runWorker(const fuzz_config_t config, uint32_t worker_id)
+{
+    rng_state = (uint64_t)time(NULL) ^ ((uint64_t)getpid() << 32) ^ worker_id;
+    if (!rng_state)
+        rng_state = 1;
+
+    // save input on interpreter crashes
+    snprintf(signal_crash_path, sizeof signal_crash_path, "%s/crashes/sig_w%02u_pid%d_sig",
+             config.out_dir, worker_id, (int)getpid());
+    signal(SIGSEGV, handleFatalSignal);
+    signal(SIGBUS, handleFatalSignal);
+    signal(SIGFPE, handleFatalSignal);
+    signal(SIGILL, handleFatalSignal);
+    signal(SIGABRT, handleFatalSignal);
+
+    chip8_t *chip8 = chip8_create();
+    uint8_t *trace = malloc(CHIP8_EDGE_MAP_SIZE);
+    queue_t *queue = calloc(1, sizeof *queue);
+    testcase_t *current = malloc(sizeof *current);
+    if (!chip8 || !trace || !queue || !current)
+    {
+        fprintf(stderr, "Worker %u: out of memory.\n", worker_id);
+        exit(EXIT_FAILURE);
+    }
+    memset(queue->top_rated, 0xFF, sizeof queue->top_rated);
+
+    // queue seeds, keeping each regardless of coverage
+    for (uint32_t i = 0; i < config.n_seeds && queue->len < MAX_QUEUE; i++)
+    {
+        runTestcase(chip8, trace, &config.seeds[i]);
+        if (queueTestcase(queue, &config.seeds[i], trace, config.out_dir, worker_id, false))
+            mergeBits(trace, shared->virgin);
+    }
+    if (queue->len == 0)
+    {
+        fprintf(stderr, "Worker %u: could not queue seeds.\n", worker_id);
+        exit(EXIT_FAILURE);
+    }
+
+    uint32_t entry = worker_id % queue->len;
+    while (!shared->stop)
+    {
+        // mostly fuzz favoured entries, the smallest inputs for some edge
+        entry = (entry + 1) % queue->len;
+        if (!queue->entries[entry]->favoured && rnd(100) < SKIP_PERCENT)
+            continue;
+
+        for (uint32_t round = 0; round < HAVOC_ROUNDS && !shared->stop; round++)
+        {
+            *current = queue->entries[entry]->tc;
+            mutate(current, queue);
+
+            const chip8_fault_t fault = runTestcase(chip8, trace, current);
+
+            if (fault != CHIP8_FAULT_NONE)
+            {
+                // only keep the first crash for each fault at each PC
+                if (!__atomic_exchange_n(&shared->crash_seen[fault][chip8->PC % CRASH_PCS], 1, __ATOMIC_RELAXED))
+                {
+                    char name[64];
+                    const uint64_t id = __atomic_fetch_add(&shared->crashes, 1, __ATOMIC_RELAXED);
+                    snprintf(name, sizeof name, "id_%06llu_w%02u_pc%03X_fault%d",
+                             (unsigned long long)id, worker_id, chip8->PC, fault);
+                    saveTestcase(current, config.out_dir, "crashes", name);
+                }
+                continue;
+            }
+
+            // coverage only counts as seen once an input reaching it has been kept
+            if (hasNewBits(trace, shared->virgin) &&
+                queueTestcase(queue, current, trace, config.out_dir, worker_id, true))
+                mergeBits(trace, shared->virgin);
+        }
+    }
+
+    for (uint32_t i = 0; i < queue->len; i++)
+        free(queue->entries[i]);
+    free(queue);
+    free(current);
+    free(trace);
+    chip8_destroy(chip8);
+}
+
+// Fork a worker process. Returns its pid, or 0 if it could not be started.
+static pid_t startWorker(const fuzz_config_t config, uint32_t worker_id)
+{
+    fflush(stdout); // don't duplicate buffered stats output in the child
+
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        fprintf(stderr, "Could not start worker %u: %s\n", worker_id, strerror(errno));
+        return 0;
+    }
+    if (pid == 0)
+    {
+        runWorker(config, worker_id);
+        _exit(EXIT_SUCCESS);
+    }
+    return pid;
+}
+
+// Replay a saved test case and report how it ended.
+static int replay(const char *path)
+{
+    testcase_t *tc = malloc(sizeof *tc);
+    uint8_t *trace = malloc(CHIP8_EDGE_MAP_SIZE);
+    chip8_t *chip8 = chip8_create();
+    shared = calloc(1, sizeof *shared);
+    if (!tc || !trace || !chip8 || !shared || !loadTestcase(tc, path))
+        return EXIT_FAILURE;
+
+    const chip8_fault_t fault = runTestcase(chip8, trace, tc);
+    printf("%s: rom %u bytes, %u frames -> PC 0x%04X, opcode 0x%04X, fault: %s\n",
+           path, tc->rom_size, tc->n_frames, chip8->PC, chip8->inst.opcode, chip8_fault_name(fault));
+
+    return fault == CHIP8_FAULT_NONE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Parse command line arguments.
+static bool setConfig_Args(fuzz_config_t *config, const int argc, char **argv)
+{
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    *config = (fuzz_config_t){
+        .workers = cores > 0 ? cores : 1, // one worker per core by default
+    };
+
+    int i = 1;
+    if (i + 1 < argc && strcmp(argv[i], "-j") == 0)
+    {
+        config->workers = strtoul(argv[i + 1], NULL, 10);
+        i += 2;
+    }
+    if (i + 1 >= argc || config->workers == 0)
+        return false;
+
+    config->out_dir = argv[i++];
+    config->n_seeds = argc - i;
+    config->seeds = calloc(config->n_seeds, sizeof *config->seeds);
+    if (!config->seeds)
+        return false;
+
+    for (uint32_t s = 0; s < config->n_seeds; s++)
+    {
+        if (!loadSeedRom(&config->seeds[s], argv[i + s]))
+            return false;
+    }
+
+    return true;
+}
+
+// Create out_dir, out_dir/queue and out_dir/crashes.
+static bool makeOutputDirs(const char *out_dir)
+{
+    const char *sub_dirs[] = {"", "/queue", "/crashes"};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        char path[4096];
+        snprintf(path, sizeof path, "%s%s", out_dir, sub_dirs[i]);
+        if (mkdir(path, 0755) != 0 && errno != EEXIST)
+        {
+            fprintf(stderr, "Could not create %s: %s\n", path, strerror(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+// MAIN FUNC
+int main(int argc, char **argv)
+{
+    initCountClasses();
+
+    if (argc == 3 && strcmp(argv[1], "-r") == 0)
+        return replay(argv[2]);
+
+    fuzz_config_t config;
+    if (!setConfig_Args(&config, argc, argv))
+    {
+        fprintf(stderr, "\nCorrect Usage: %s [-j workers] <out_dir> <seed_rom>...\n"
+                        "               %s -r <test_case>\n\n",
+                argv[0], argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    if (!makeOutputDirs(config.out_dir))
+        exit(EXIT_FAILURE);
+
+    shared = mmap(NULL, sizeof *shared, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED)
+    {
+        fprintf(stderr, "Could not map shared coverage bitmap: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    // one worker process per core
+    pid_t *pids = calloc(config.workers, sizeof *pids);
+    uint32_t *restarts = calloc(config.workers, sizeof *restarts);
+    if (!pids || !restarts)
+        exit(EXIT_FAILURE);
+
+    for (uint32_t w = 0; w < config.workers && !shared->stop; w++)
+        pids[w] = startWorker(config, w);
+
+    // report progress once a second until stopped, restarting workers that crash
+    const time_t start = time(NULL);
+    while (!shared->stop)
+    {
+        sleep(1);
+
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            uint32_t w = 0;
+            while (w < config.workers && pids[w] != pid)
+                w++;
+            if (w == config.workers)
+                continue;
+            pids[w] = 0;
+
+            if (WIFSIGNALED(status))
+            {
+                // handleFatalSignal() only saves if the signal hit inside runTestcase()
+                char path[4096];
+                snprintf(path, sizeof path, "%s/crashes/sig_w%02u_pid%d_sig%d",
+                         config.out_dir, w, (int)pid, WTERMSIG(status));
+                printf("\nWorker %u (pid %d) killed by signal %d (%s).\n",
+                       w, (int)pid, WTERMSIG(status), strsignal(WTERMSIG(status)));
+                if (access(path, F_OK) == 0)
+                    printf("Input saved to %s\n", path);
+                if (restarts[w]++ < MAX_RESTARTS)
+                    pids[w] = startWorker(config, w);
+                else
+                    printf("Worker %u crashed %u times, not restarting.\n", w, MAX_RESTARTS + 1);
+            }
+            else
+            {
+                printf("\nWorker %u (pid %d) exited with status %d.\n", w, (int)pid, WEXITSTATUS(status));
+            }
+        }
+
+        uint32_t alive = 0;
+        for (uint32_t w = 0; w < config.workers; w++)
+            alive += pids[w] > 0;
+        if (alive == 0)
+        {
+            fprintf(stderr, "\nNo workers left running.\n");
+            break;
+        }
+
+        const time_t elapsed = time(NULL) - start;
+        const uint64_t execs = __atomic_load_n(&shared->execs, __ATOMIC_RELAXED);
+        printf("\r%lds | workers %u | execs %llu (%llu/s) | paths %llu | crashes %llu   ",
+               (long)elapsed, alive, (unsigned long long)execs,
+               (unsigned long long)(elapsed ? execs / elapsed : execs),
+               (unsigned long long)__atomic_load_n(&shared->paths, __ATOMIC_RELAXED),
+               (unsigned long long)__atomic_load_n(&shared->crashes, __ATOMIC_RELAXED));
+        fflush(stdout);
+    }
+
+    while (wait(NULL) > 0)
+        ; // wait for workers to finish
+    puts("");
+
+    exit(EXIT_SUCCESS);
+}
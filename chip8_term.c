@@ -0,0 +1,332 @@
+#define _DEFAULT_SOURCE // cfmakeraw, clock_nanosleep
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "chip8_core.h"
+
+// Terminal frontend for SSH/headless use. Draws the display with Unicode half blocks, two chip8
+// rows per text line, and only redraws the changed span of lines whose rows were dirtied by
+// 00E0/DXYN. Each frame is sent in a single write(). Keypad input comes from raw mode stdin.
+
+#define TEXT_LINES (CHIP8_DISPLAY_HEIGHT / 2)
+#define FRAME_NS (1000000000L / 60)
+// Terminals have no key up events, so keys are released this long after the last keystroke.
+// Must exceed the terminal's auto-repeat delay (usually ~500ms) for held keys to stay down.
+#define KEY_HOLD_MS 650
+
+// Half block cells, indexed by (top pixel | bottom pixel << 1).
+static const char *const cells[4] = {" ", "▀", "▄", "█"};
+
+// Terminal state.
+typedef struct
+{
+    struct termios original;                         // restored on exit
+    bool raw;                                        // terminal is in raw mode
+    uint8_t shadow[TEXT_LINES][CHIP8_DISPLAY_WIDTH]; // cells currently shown on the terminal
+    uint32_t key_hold[16];                           // frames left before key is released
+    uint32_t key_hold_frames;                        // frames a key stays pressed after each keystroke
+    char out[TEXT_LINES * (16 + CHIP8_DISPLAY_WIDTH * 3) + 64];
+    size_t out_len;
+} term_t;
+
+static term_t term;
+static volatile sig_atomic_t resized = true; // force full redraw on first frame
+static volatile sig_atomic_t quit;           // SIGTERM/SIGHUP/SIGQUIT received
+
+static void handleResize(int sig)
+{
+    (void)sig;
+    resized = true;
+}
+
+// End main loop so the terminal is restored before exit.
+static void handleQuit(int sig)
+{
+    (void)sig;
+    quit = true;
+}
+
+// Queue bytes for the next write().
+static void emit(const char *data, size_t len)
+{
+    memcpy(&term.out[term.out_len], data, len);
+    term.out_len += len;
+}
+
+// Send queued bytes in one write().
+static void flushOutput(void)
+{
+    size_t written = 0;
+    while (written < term.out_len)
+    {
+        const ssize_t n = write(STDOUT_FILENO, &term.out[written], term.out_len - written);
+        if (n <= 0)
+            break;
+        written += n;
+    }
+    term.out_len = 0;
+}
+
+// Restore terminal on exit.
+static void restoreTerminal(void)
+{
+    if (!term.raw)
+        return;
+    term.raw = false;
+
+    char reset[32];
+    const int len = snprintf(reset, sizeof reset, "\x1b[0m\x1b[%u;1H\x1b[?25h\r\n", TEXT_LINES + 1);
+    emit(reset, len);
+    flushOutput();
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &term.original);
+}
+
+// Put stdin in non-blocking raw mode and hide cursor.
+static bool initTerminal(void)
+{
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &term.original) != 0)
+    {
+        fprintf(stderr, "stdin is not a terminal.\n");
+        return false;
+    }
+
+    struct termios raw = term.original;
+    cfmakeraw(&raw);
+    raw.c_cc[VMIN] = 0; // read() returns immediately
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0)
+    {
+        fprintf(stderr, "Unable to set terminal raw mode.\n");
+        return false;
+    }
+    term.raw = true;
+    atexit(restoreTerminal);
+
+    signal(SIGWINCH, handleResize);
+    signal(SIGTERM, handleQuit);
+    signal(SIGHUP, handleQuit);
+    signal(SIGQUIT, handleQuit);
+    emit("\x1b[?25l", 6);
+
+    return true;
+}
+
+// Map a key to the chip8 keypad, using the usual layout:
+//  1 2 3 4      1 2 3 C
+//  q w e r  ->  4 5 6 D
+//  a s d f      7 8 9 E
+//  z x c v      A 0 B F
+static int keypadIndex(char key)
+{
+    static const char keys[16] = {'x', '1', '2', '3', 'q', 'w', 'e', 'a',
+                                  's', 'd', 'z', 'c', '4', 'r', 'f', 'v'};
+    if (key >= 'A' && key <= 'Z')
+        key += 'a' - 'A';
+    for (int i = 0; i < 16; i++)
+    {
+        if (keys[i] == key)
+            return i;
+    }
+    return -1;
+}
+
+// Handle user input.
+static void handleInput(chip8_t *chip8)
+{
+    // release keys that have not repeated recently
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (term.key_hold[i] > 0 && --term.key_hold[i] == 0)
+            chip8->keypad[i] = false;
+    }
+
+    char buf[64];
+    const ssize_t len = read(STDIN_FILENO, buf, sizeof buf);
+    for (ssize_t i = 0; i < len; i++)
+    {
+        switch (buf[i])
+        {
+        case 0x03:
+            // Ctrl-C: raw mode disables SIGINT, end program.
+            chip8->state = CHIP8_QUIT;
+            return;
+        case 0x1B:
+            // Lone escape key: end program.
+            if (i == len - 1)
+            {
+                chip8->state = CHIP8_QUIT;
+                return;
+            }
+            // Skip escape sequences (arrow keys, alt+key etc.): CSI "ESC [ params final" where final
+            // is 0x40-0x7E, SS3 "ESC O final", or ESC followed by one key.
+            i++;
+            if (buf[i] == '[')
+            {
+                while (i + 1 < len && !(buf[i + 1] >= 0x40 && buf[i + 1] <= 0x7E))
+                    i++;
+                i++;
+            }
+            else if (buf[i] == 'O')
+            {
+                i++;
+            }
+            break;
+        case ' ':
+            // Space bar
+            chip8->state = chip8->state == CHIP8_RUNNING ? CHIP8_PAUSED : CHIP8_RUNNING;
+            break;
+        default:
+            {
+                const int key = keypadIndex(buf[i]);
+                if (key >= 0)
+                {
+                    chip8->keypad[key] = true;
+                    term.key_hold[key] = term.key_hold_frames;
+                }
+            }
+            break;
+        }
+    }
+}
+
+// Redraw the changed part of each text line whose chip8 rows are dirty.
+static void updateScreen(chip8_t *chip8)
+{
+    uint32_t dirty_rows = chip8_take_dirty_rows(chip8);
+    if (resized)
+    {
+        // terminal contents unknown, redraw everything
+        resized = false;
+        emit("\x1b[2J", 4);
+        memset(term.shadow, 0xFF, sizeof term.shadow);
+        dirty_rows = UINT32_MAX;
+    }
+
+    const bool *display = chip8_display(chip8);
+    for (uint32_t line = 0; line < TEXT_LINES; line++)
+    {
+        if (!(dirty_rows & (3u << (line * 2))))
+            continue;
+
+        const bool *top = &display[line * 2 * CHIP8_DISPLAY_WIDTH];
+        const bool *bottom = top + CHIP8_DISPLAY_WIDTH;
+        int first = -1, last = -1;
+        uint8_t line_cells[CHIP8_DISPLAY_WIDTH];
+
+        // find span of cells that differ from what is on screen
+        for (int x = 0; x < CHIP8_DISPLAY_WIDTH; x++)
+        {
+            line_cells[x] = top[x] | bottom[x] << 1;
+            if (line_cells[x] != term.shadow[line][x])
+            {
+                if (first < 0)
+                    first = x;
+                last = x;
+            }
+        }
+        if (first < 0)
+            continue; // sprite drawn and erased within the frame
+
+        char move[16];
+        emit(move, snprintf(move, sizeof move, "\x1b[%u;%dH", line + 1, first + 1));
+        for (int x = first; x <= last; x++)
+        {
+            emit(cells[line_cells[x]], strlen(cells[line_cells[x]]));
+            term.shadow[line][x] = line_cells[x];
+        }
+    }
+
+    flushOutput();
+}
+
+// Read ROM file into machine.
+static bool initCHIP(chip8_t *chip8, const char rom_name[])
+{
+    uint8_t rom_data[sizeof chip8->ram - CHIP8_ENTRY_POINT + 1];
+
+    FILE *rom = fopen(rom_name, "rb");
+    if (!rom)
+    {
+        fprintf(stderr, "ROM file %s is invalid or does not exist.\n", rom_name);
+        return false;
+    }
+    const size_t rom_size = fread(rom_data, 1, sizeof rom_data, rom);
+    fclose(rom);
+
+    if (!chip8_load_rom_from_memory(chip8, rom_data, rom_size))
+    {
+        fprintf(stderr, "ROM file %s is too big.\nMax size allowed: %zu\n",
+                rom_name, sizeof rom_data - 1);
+        return false;
+    }
+    chip8->rom_name = rom_name;
+
+    return true;
+}
+
+// MAIN FUNC
+int main(int argc, char **argv)
+{
+    // parse args: [-k hold_ms] <rom_name>
+    uint32_t hold_ms = KEY_HOLD_MS;
+    int rom_arg = 1;
+    if (argc > 1 && strcmp(argv[1], "-k") == 0)
+    {
+        hold_ms = argc > 2 ? strtoul(argv[2], NULL, 10) : 0;
+        rom_arg = 3;
+    }
+
+    // default usage message for args
+    if (rom_arg >= argc || hold_ms == 0)
+    {
+        fprintf(stderr, "\nNo ROM selected.\nCorrect Usage: %s [-k key_hold_ms] <rom_name>\n\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    term.key_hold_frames = (hold_ms * 60 + 999) / 1000;
+
+    chip8_t *chip8 = chip8_create();
+    if (!chip8 || !initCHIP(chip8, argv[rom_arg]))
+        exit(EXIT_FAILURE);
+
+    if (!initTerminal())
+        exit(EXIT_FAILURE);
+
+    struct timespec next_frame;
+    clock_gettime(CLOCK_MONOTONIC, &next_frame);
+
+    // Main emulator loop
+    while (chip8->state != CHIP8_QUIT && !quit)
+    {
+        handleInput(chip8);
+
+        if (chip8->state == CHIP8_RUNNING)
+            chip8_run_frames(chip8, 1);
+
+        updateScreen(chip8);
+
+        // wait for next 60hz frame
+        next_frame.tv_nsec += FRAME_NS;
+        if (next_frame.tv_nsec >= 1000000000L)
+        {
+            next_frame.tv_nsec -= 1000000000L;
+            next_frame.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_frame, NULL);
+    }
+
+    restoreTerminal();
+
+    if (chip8->fault != CHIP8_FAULT_NONE)
+        fprintf(stderr, "ROM %s stopped at 0x%04X: %s\n", chip8->rom_name, chip8->PC, chip8_fault_name(chip8->fault));
+
+    chip8_destroy(chip8);
+    exit(EXIT_SUCCESS);
+}